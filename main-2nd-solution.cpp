@@ -5,6 +5,17 @@
 #include <set>
 #include <map>
 #include <queue>
+#include <algorithm>
+#include <random>
+#include <chrono>
+#include <cstdint>
+#include <cstddef>
+
+// the batched BitGraph kernels use AVX2/AVX-512 when the CPU supports them (checked at runtime)
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#define MYGRAPH_X86_DISPATCH 1
+#include <immintrin.h>
+#endif
 
 using namespace std;
 
@@ -400,6 +411,344 @@ std::ostream& operator<< (std::ostream& os, const BfsGraph& bfsGraph) {
   return os;
 }
 
+// index of the lowest set bit of a non-zero word
+inline int lowestBit(uint64_t x)
+{
+#if defined(__GNUC__) || defined(__clang__)
+  return __builtin_ctzll(x);
+#else
+  int i = 0;
+  for (; (x & 1) == 0; x >>= 1)
+  {
+    ++i;
+  }
+  return i;
+#endif
+}
+
+// BitGraph is a specialized graph for tiny graphs (at most 64 vertices):
+// each vertex has one uint64_t adjacency row, so the whole graph lives in a fixed-size array
+// and BFS frontier expansion is done with bitwise operations, without any heap allocation.
+// Self-loops and parallel edges are kept as cycles (same as BfsGraph), so the graph is a forest
+// iff E <= V - C, with C is the number of connected components.
+class BitGraph
+{
+public:
+  static constexpr int max_vertices = 64;
+
+private:
+  // data members
+  uint64_t adjs[max_vertices]; // bit j of adjs[i] is set iff there is an edge between vertex i and vertex j (as per index)
+  uint64_t vertices; // bit i is set iff index i is used
+  int size; // number of vertices, continually increasing index: 0,1,2,3,...
+  size_t edgeCount; // number of edges, including self-loops and parallel edges
+
+  // find index of a label among the first "count" labels and add it if not present yet,
+  // return -1 if there are already 64 vertices
+  int indexOf(Bfs_label label, Bfs_label* labels, int& count)
+  {
+    int found = -1;
+    for (int i=0; i<count; ++i) // O(V) with V <= 64, no early exit: the loop length is predictable, the match is not
+    {
+      found = labels[i] == label ? i : found;
+    }
+    if (found >= 0 || count == max_vertices)
+    {
+      return found;
+    }
+    labels[count] = label;
+    adjs[count] = 0;
+    return count++;
+  }
+
+public:
+  BitGraph() : vertices{0}, size{0}, edgeCount{0} {}
+
+  // (re)build a BitGraph from a vector of Edges, return false if the graph has more than 64 vertices
+  // input: E edges
+  // time complexity: O(V.E) with V <= 64
+  bool assign(const vector<Edge>& in)
+  {
+    // labels are only needed while building, so they stay on the stack and BitGraph keeps only its adjacency rows
+    Bfs_label labels[max_vertices]; // real name/value of vertex at each index
+    int count = 0;
+    bool tiny = true;
+    for (auto const e : in)
+    {
+      auto i = indexOf(e.source, labels, count);
+      auto j = indexOf(e.destination, labels, count);
+      if (i < 0 || j < 0)
+      {
+        tiny = false;
+        break;
+      }
+      adjs[i] |= uint64_t{1} << j;
+      adjs[j] |= uint64_t{1} << i;
+    }
+    size = tiny ? count : 0;
+    vertices = size == max_vertices ? ~uint64_t{0} : (uint64_t{1} << size) - 1;
+    edgeCount = tiny ? in.size() : 0;
+    return tiny;
+  }
+
+  uint64_t getVertices() const
+  {
+    return vertices;
+  }
+  // all adjacency rows, used by the SIMD kernels to gather one row per graph
+  const uint64_t* getAdjsData() const
+  {
+    return adjs;
+  }
+
+  // number of connected components, using BFS with bitwise frontier expansion
+  // time complexity: O(V+E) with V <= 64
+  int countComponents() const
+  {
+    int count = 0;
+    uint64_t remain_vertices = vertices;
+    while (remain_vertices != 0) // there is a disjoint set to start BFS
+    {
+      uint64_t discovered = remain_vertices & (~remain_vertices + 1); // lowest remaining vertex
+      uint64_t frontier = discovered;
+      while (frontier != 0) // all vertices of the frontier are discovered at once
+      {
+        uint64_t next = 0;
+        for (uint64_t f = frontier; f != 0; f &= f - 1)
+        {
+          next |= adjs[lowestBit(f)];
+        }
+        frontier = next & ~discovered;
+        discovered |= frontier;
+      }
+      remain_vertices &= ~discovered;
+      ++count;
+    }
+    return count;
+  }
+
+  // check for cycle when the number of connected components is already known (see MyGraph::countComponents)
+  bool has_cycle(int components) const
+  {
+    return edgeCount > static_cast<size_t>(size - components);
+  }
+
+  // false if has_cycle() is answered without BFS: empty graph, or E >= V > V - C for any C >= 1
+  bool needsComponents() const
+  {
+    return size != 0 && edgeCount < static_cast<size_t>(size);
+  }
+
+  // time complexity: O(V+E) with V <= 64
+  bool has_cycle() const
+  {
+    if (!needsComponents())
+    {
+      return size != 0;
+    }
+    return has_cycle(countComponents());
+  }
+};
+
+
+// Kernels counting connected components of many BitGraphs: comps[k] = graphs[k].countComponents().
+// The SIMD kernels process one graph per 64-bit lane, each lane runs the same BFS as BitGraph::countComponents()
+// but expands one vertex of its own frontier per step: the adjacency row of that vertex is gathered from the graph
+// of the lane, so a block of graphs takes max(V)+1 steps. The gather latency is hidden by interleaving
+// independent blocks, so there is no per-vertex-index sweep and no transpose of the adjacency rows.
+using ComponentsKernel = void (*)(const BitGraph* graphs, size_t n, int* comps);
+
+void countComponents_scalar(const BitGraph* graphs, size_t n, int* comps)
+{
+  for (size_t k=0; k<n; ++k)
+  {
+    comps[k] = graphs[k].countComponents();
+  }
+}
+
+#ifdef MYGRAPH_X86_DISPATCH
+// distance (in uint64_t) between the adjacency rows of two consecutive BitGraphs of an array, used as gather index
+constexpr long long bitGraphStride = sizeof(BitGraph) / sizeof(uint64_t);
+static_assert(sizeof(BitGraph) % sizeof(uint64_t) == 0, "BitGraph adjacency rows must be gathered as uint64_t");
+
+__attribute__((target("avx2")))
+void countComponents_avx2(const BitGraph* graphs, size_t n, int* comps)
+{
+  constexpr size_t lanes = 4;
+  constexpr size_t blocks = 4; // blocks of graphs interleaved to hide the gather latency
+  const __m256i zero = _mm256_setzero_si256();
+  const __m256i ones = _mm256_set1_epi64x(-1);
+  const __m256i laneOffset = _mm256_set_epi64x(3*bitGraphStride, 2*bitGraphStride, bitGraphStride, 0);
+  const __m256i low32 = _mm256_set1_epi64x(0xFFFFFFFF);
+  const __m256i exponent = _mm256_set1_epi32(0xFF);
+  const __m256i bias = _mm256_set1_epi64x(127);
+  const __m256i high32 = _mm256_set1_epi64x(32);
+  for (size_t group = 0; group < n; group += lanes * blocks)
+  {
+    __m256i vertices[blocks], discovered[blocks], frontier[blocks], count[blocks];
+    const long long* rows[blocks]; // adjacency rows of the first graph of each block
+    size_t used[blocks]; // padding lanes (after the last graph) are empty graphs
+    alignas(32) uint64_t lane[lanes];
+    for (size_t b=0; b<blocks; ++b)
+    {
+      const size_t base = group + b * lanes;
+      used[b] = base >= n ? 0 : min(n - base, lanes);
+      for (size_t l=0; l<lanes; ++l)
+      {
+        lane[l] = l < used[b] ? graphs[base+l].getVertices() : 0;
+      }
+      vertices[b] = _mm256_load_si256(reinterpret_cast<const __m256i*>(lane));
+      rows[b] = reinterpret_cast<const long long*>(graphs[used[b] != 0 ? base : group].getAdjsData());
+      discovered[b] = frontier[b] = count[b] = zero;
+    }
+
+    bool any_active = true;
+    while (any_active)
+    {
+      __m256i active_lanes = zero;
+      for (size_t b=0; b<blocks; ++b)
+      {
+        // lanes with empty frontier start BFS from their lowest remaining vertex, if any
+        const __m256i remain_vertices = _mm256_andnot_si256(discovered[b], vertices[b]);
+        const __m256i seed = _mm256_and_si256(_mm256_and_si256(remain_vertices, _mm256_sub_epi64(zero, remain_vertices)),
+                                              _mm256_cmpeq_epi64(frontier[b], zero));
+        frontier[b] = _mm256_or_si256(frontier[b], seed);
+        discovered[b] = _mm256_or_si256(discovered[b], seed);
+        count[b] = _mm256_sub_epi64(count[b], _mm256_andnot_si256(_mm256_cmpeq_epi64(seed, zero), ones));
+        const __m256i active = _mm256_andnot_si256(_mm256_cmpeq_epi64(frontier[b], zero), ones);
+        active_lanes = _mm256_or_si256(active_lanes, active);
+
+        // take the lowest vertex of each frontier, its index is the float exponent of the 32-bit half holding it
+        const __m256i vertex = _mm256_and_si256(frontier[b], _mm256_sub_epi64(zero, frontier[b]));
+        frontier[b] = _mm256_xor_si256(frontier[b], vertex);
+        const __m256i e = _mm256_and_si256(_mm256_srli_epi32(_mm256_castps_si256(_mm256_cvtepi32_ps(vertex)), 23), exponent);
+        const __m256i eLow = _mm256_and_si256(e, low32);
+        const __m256i index = _mm256_add_epi64(_mm256_sub_epi64(_mm256_add_epi64(eLow, _mm256_srli_epi64(e, 32)), bias),
+                                               _mm256_and_si256(_mm256_cmpeq_epi64(eLow, zero), high32));
+
+        // add the undiscovered neighbours of that vertex to the frontier
+        const __m256i adjs = _mm256_mask_i64gather_epi64(zero, rows[b], _mm256_add_epi64(laneOffset, index), active, 8);
+        const __m256i fresh = _mm256_andnot_si256(discovered[b], adjs);
+        discovered[b] = _mm256_or_si256(discovered[b], fresh);
+        frontier[b] = _mm256_or_si256(frontier[b], fresh);
+      }
+      any_active = !_mm256_testz_si256(active_lanes, active_lanes);
+    }
+
+    for (size_t b=0; b<blocks; ++b)
+    {
+      _mm256_store_si256(reinterpret_cast<__m256i*>(lane), count[b]);
+      for (size_t l=0; l<used[b]; ++l)
+      {
+        comps[group + b*lanes + l] = static_cast<int>(lane[l]);
+      }
+    }
+  }
+}
+
+// GCC 12 headers build _mm512_andnot_si512 on _mm512_undefined_epi32(), which triggers a false -Wmaybe-uninitialized
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+#endif
+__attribute__((target("avx512f,avx512cd")))
+void countComponents_avx512(const BitGraph* graphs, size_t n, int* comps)
+{
+  constexpr size_t lanes = 8;
+  constexpr size_t blocks = 4; // blocks of graphs interleaved to hide the gather latency
+  const __m512i zero = _mm512_setzero_si512();
+  const __m512i one = _mm512_set1_epi64(1);
+  const __m512i highest = _mm512_set1_epi64(63);
+  const __m512i laneOffset = _mm512_set_epi64(7*bitGraphStride, 6*bitGraphStride, 5*bitGraphStride, 4*bitGraphStride,
+                                              3*bitGraphStride, 2*bitGraphStride, bitGraphStride, 0);
+  for (size_t group = 0; group < n; group += lanes * blocks)
+  {
+    __m512i vertices[blocks], discovered[blocks], frontier[blocks], count[blocks];
+    const long long* rows[blocks]; // adjacency rows of the first graph of each block
+    size_t used[blocks]; // padding lanes (after the last graph) are empty graphs
+    alignas(64) uint64_t lane[lanes];
+    for (size_t b=0; b<blocks; ++b)
+    {
+      const size_t base = group + b * lanes;
+      used[b] = base >= n ? 0 : min(n - base, lanes);
+      for (size_t l=0; l<lanes; ++l)
+      {
+        lane[l] = l < used[b] ? graphs[base+l].getVertices() : 0;
+      }
+      vertices[b] = _mm512_load_si512(lane);
+      rows[b] = reinterpret_cast<const long long*>(graphs[used[b] != 0 ? base : group].getAdjsData());
+      discovered[b] = frontier[b] = count[b] = zero;
+    }
+
+    bool any_active = true;
+    while (any_active)
+    {
+      __mmask8 active_lanes = 0;
+      for (size_t b=0; b<blocks; ++b)
+      {
+        // lanes with empty frontier start BFS from their lowest remaining vertex, if any
+        const __mmask8 empty = _mm512_testn_epi64_mask(frontier[b], frontier[b]);
+        const __m512i remain_vertices = _mm512_andnot_si512(discovered[b], vertices[b]);
+        const __m512i seed = _mm512_and_si512(remain_vertices, _mm512_sub_epi64(zero, remain_vertices));
+        frontier[b] = _mm512_mask_mov_epi64(frontier[b], empty, seed);
+        discovered[b] = _mm512_or_si512(discovered[b], frontier[b]);
+        count[b] = _mm512_mask_add_epi64(count[b], empty & _mm512_test_epi64_mask(seed, seed), count[b], one);
+        const __mmask8 active = _mm512_test_epi64_mask(frontier[b], frontier[b]);
+        active_lanes |= active;
+
+        // take the lowest vertex of each frontier
+        const __m512i vertex = _mm512_and_si512(frontier[b], _mm512_sub_epi64(zero, frontier[b]));
+        frontier[b] = _mm512_xor_si512(frontier[b], vertex);
+        const __m512i index = _mm512_sub_epi64(highest, _mm512_lzcnt_epi64(vertex));
+
+        // add the undiscovered neighbours of that vertex to the frontier
+        const __m512i adjs = _mm512_mask_i64gather_epi64(zero, active, _mm512_add_epi64(laneOffset, index), rows[b], 8);
+        const __m512i fresh = _mm512_andnot_si512(discovered[b], adjs);
+        discovered[b] = _mm512_or_si512(discovered[b], fresh);
+        frontier[b] = _mm512_or_si512(frontier[b], fresh);
+      }
+      any_active = active_lanes != 0;
+    }
+
+    for (size_t b=0; b<blocks; ++b)
+    {
+      _mm512_store_si512(lane, count[b]);
+      for (size_t l=0; l<used[b]; ++l)
+      {
+        comps[group + b*lanes + l] = static_cast<int>(lane[l]);
+      }
+    }
+  }
+}
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic pop
+#endif
+#endif // MYGRAPH_X86_DISPATCH
+
+// choose the widest kernel supported by the running CPU
+ComponentsKernel selectComponentsKernel()
+{
+#ifdef MYGRAPH_X86_DISPATCH
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512cd"))
+  {
+    return countComponents_avx512;
+  }
+  if (__builtin_cpu_supports("avx2"))
+  {
+    return countComponents_avx2;
+  }
+#endif
+  return countComponents_scalar;
+}
+
+// count connected components of many BitGraphs with the widest kernel supported by the running CPU
+void countComponents(const BitGraph* graphs, size_t n, int* comps)
+{
+  static const ComponentsKernel kernel = selectComponentsKernel(); // CPU features are checked only once
+  kernel(graphs, n, comps);
+}
+
 } // namespace BfsGraph
 
 
@@ -414,17 +763,11 @@ void printBfsEdges(const vector<Edge>& in)
   cout << "*****printBfsEdges*****end\n";
 }
 
+// has_cycle for a graph with more than 64 vertices
 // input: E edges
 // time complexity: O(V.E) = O(E^(3/2)), with V = O(E^(1/2))
-bool has_cycle(const vector<Edge> &edges) {
-  // Implement your solution here to detect whether this undirected graph contains a cycle or not.
-
+bool has_cycle_large(const vector<Edge> &edges) {
   //step1: hande special cases
-  //printEdges(edges); //debug
-  if (edges.empty())
-  {
-    return false;
-  }
   for (auto const e : edges)
   {
     if (e.source == e.destination)
@@ -440,6 +783,231 @@ bool has_cycle(const vector<Edge> &edges) {
   return mygraph.has_cycle();       // O(VlogV+E) with V = O(E^(1/2))
 }
 
+// input: E edges
+// time complexity: O(V.E) with V <= 64, otherwise O(V.E) = O(E^(3/2)), with V = O(E^(1/2))
+bool has_cycle(const vector<Edge> &edges) {
+  // Implement your solution here to detect whether this undirected graph contains a cycle or not.
+
+  //step1: hande special cases
+  //printEdges(edges); //debug
+  if (edges.empty())
+  {
+    return false;
+  }
+
+  //step2: for a tiny graph (at most 64 vertices), create a BitGraph on the stack and invoke has_cycle() member function
+  MyGraph::BitGraph tinygraph;
+  if (tinygraph.assign(edges))      // O(V.E) with V <= 64
+  {
+    return tinygraph.has_cycle();   // O(V+E) with V <= 64
+  }
+
+  //step3: otherwise use a BfsGraph
+  return has_cycle_large(edges);
+}
+
+// input: N graphs
+// tiny graphs (at most 64 vertices) needing BFS are checked together by MyGraph::countComponents (see checkTinygraphs), the others one by one
+vector<bool> has_cycles(const vector<vector<Edge>>& graphs) {
+  constexpr size_t chunk = 64; // tiny graphs are batched by chunk, so the BitGraphs being checked stay in cache
+  vector<bool> result(graphs.size());
+  vector<MyGraph::BitGraph> tinygraphs(chunk); // the next graph is always built in tinygraphs[used], no copy
+  size_t tinyIndexes[chunk]; // index in "graphs" of each used item of "tinygraphs"
+  size_t used = 0;
+
+  auto checkTinygraphs = [&] {
+    int comps[chunk];
+    MyGraph::countComponents(tinygraphs.data(), used, comps);
+    for (size_t t=0; t<used; ++t)
+    {
+      result[tinyIndexes[t]] = tinygraphs[t].has_cycle(comps[t]);
+    }
+    used = 0;
+  };
+
+  for (size_t k=0; k<graphs.size(); ++k)
+  {
+    auto& tinygraph = tinygraphs[used];
+    if (!tinygraph.assign(graphs[k]))
+    {
+      result[k] = has_cycle_large(graphs[k]);
+    }
+    else if (!tinygraph.needsComponents()) // answered without BFS, no need to batch it
+    {
+      result[k] = tinygraph.has_cycle();
+    }
+    else
+    {
+      tinyIndexes[used++] = k;
+      if (used == chunk)
+      {
+        checkTinygraphs();
+      }
+    }
+  }
+  checkTinygraphs();
+  return result;
+}
+
+// random graph with V vertices: a random tree, or a random forest when "forest" is true,
+// plus "extra" random edges (self-loops and parallel edges included)
+vector<Edge> random_graph(mt19937& rng, int V, bool forest, int extra) {
+  vector<int> labels(V);
+  for (int i=0; i<V; ++i)
+  {
+    labels[i] = 5 * i - 100;
+  }
+  shuffle(labels.begin(), labels.end(), rng);
+  vector<Edge> edges;
+  for (int i=1; i<V; ++i)
+  {
+    if (!forest || rng() % 5 != 0)
+    {
+      edges.push_back({labels[rng() % i], labels[i]});
+    }
+  }
+  for (; extra > 0; --extra)
+  {
+    edges.push_back({labels[rng() % V], labels[rng() % V]});
+  }
+  return edges;
+}
+
+// SIMD kernels supported by the running CPU
+vector<pair<const char*, MyGraph::ComponentsKernel>> simd_kernels() {
+  vector<pair<const char*, MyGraph::ComponentsKernel>> kernels;
+#ifdef MYGRAPH_X86_DISPATCH
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("avx2"))
+  {
+    kernels.push_back({"avx2", MyGraph::countComponents_avx2});
+  }
+  if (__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512cd"))
+  {
+    kernels.push_back({"avx512", MyGraph::countComponents_avx512});
+  }
+#endif
+  return kernels;
+}
+
+// check the SIMD kernels against countComponents_scalar, and has_cycle()/has_cycles() against BfsGraph,
+// on random graphs with 1-64 vertices (plus some with more than 64 vertices), return true if all results agree
+bool self_check() {
+  mt19937 rng(2024);
+  auto randomGraph = [&](int V) {
+    return random_graph(rng, V, true, rng() % 4 == 0 ? rng() % 3 : 0);
+  };
+  auto kernels = simd_kernels();
+
+  int mismatches = 0;
+  for (int round=0; round<2000; ++round)
+  {
+    // 1 to 70 graphs: covers padding lanes (n % 4 != 0, n % 8 != 0) and partially used interleaved blocks
+    const size_t n = 1 + rng() % 70;
+    vector<vector<Edge>> graphs;
+    vector<MyGraph::BitGraph> tinygraphs(n);
+    for (size_t k=0; k<n; ++k)
+    {
+      graphs.push_back(randomGraph(1 + rng() % MyGraph::BitGraph::max_vertices));
+      tinygraphs[k].assign(graphs.back());
+    }
+
+    vector<int> expected(n);
+    MyGraph::countComponents_scalar(tinygraphs.data(), n, expected.data());
+    for (auto const& kernel : kernels)
+    {
+      vector<int> comps(n);
+      kernel.second(tinygraphs.data(), n, comps.data());
+      for (size_t k=0; k<n; ++k)
+      {
+        if (comps[k] != expected[k])
+        {
+          cout << kernel.first << " kernel: graph " << k << " of " << n << " has " << comps[k] << " components instead of " << expected[k] << "\n";
+          ++mismatches;
+        }
+      }
+    }
+
+    // graphs with more than 64 vertices go through the BfsGraph fallback of has_cycles()
+    if (round % 10 == 0)
+    {
+      graphs.push_back(randomGraph(MyGraph::BitGraph::max_vertices + 1 + rng() % 16));
+    }
+    auto results = has_cycles(graphs);
+    for (size_t k=0; k<graphs.size(); ++k)
+    {
+      const bool reference = !graphs[k].empty() && has_cycle_large(graphs[k]);
+      if (results[k] != reference || has_cycle(graphs[k]) != reference)
+      {
+        cout << "has_cycles: graph " << k << " of " << graphs.size() << " gives a wrong result\n";
+        ++mismatches;
+      }
+    }
+  }
+
+  cout << "self-check: " << mismatches << " mismatches, kernels checked against scalar:";
+  for (auto const& kernel : kernels)
+  {
+    cout << " " << kernel.first;
+  }
+  cout << "\n";
+  return mismatches == 0;
+}
+
+
+// best time of "rounds" runs of f, in ns per graph
+template <typename F>
+double time_per_graph(F f, size_t graphs, int rounds = 30) {
+  double best = 1e18;
+  for (int r=0; r<rounds; ++r)
+  {
+    auto start = chrono::steady_clock::now();
+    f();
+    best = min(best, chrono::duration<double, nano>(chrono::steady_clock::now() - start).count() / graphs);
+  }
+  return best;
+}
+
+// compare has_cycle() in a loop with has_cycles() on copies of the given graphs,
+// and the SIMD kernels with countComponents_scalar on random trees and forests
+void benchmark(const vector<Edge>& edges_with_cycle, const vector<Edge>& edges_without_cycle) {
+  constexpr size_t count = 4096;
+  long found = 0; // printed, so that the checks are not optimized away
+
+  vector<vector<Edge>> graphs;
+  for (size_t k=0; k<count; ++k)
+  {
+    graphs.push_back(k % 2 == 0 ? edges_with_cycle : edges_without_cycle);
+  }
+  auto loop = time_per_graph([&] { for (auto const& edges : graphs) found += has_cycle(edges); }, count);
+  auto batch = time_per_graph([&] { for (auto cycle_found : has_cycles(graphs)) found += cycle_found; }, count);
+  cout << "main() graphs: has_cycle loop " << loop << " ns, has_cycles " << batch << " ns per graph\n";
+
+  mt19937 rng(2024);
+  auto kernels = simd_kernels();
+  for (int V : {12, 40, 64})
+  {
+    for (bool forest : {false, true})
+    {
+      vector<MyGraph::BitGraph> tinygraphs(count);
+      for (auto& tinygraph : tinygraphs)
+      {
+        tinygraph.assign(random_graph(rng, V, forest, 0));
+      }
+      vector<int> comps(count);
+      cout << "V=" << V << (forest ? " forest:" : " tree:") << " scalar "
+           << time_per_graph([&] { MyGraph::countComponents_scalar(tinygraphs.data(), count, comps.data()); }, count);
+      for (auto const& kernel : kernels)
+      {
+        cout << ", " << kernel.first << " "
+             << time_per_graph([&] { kernel.second(tinygraphs.data(), count, comps.data()); }, count);
+      }
+      found += comps[0];
+      cout << " ns per graph\n";
+    }
+  }
+  cout << "(" << found << ")\n";
+}
 
 void report_results(bool cycle_found) {
   if (cycle_found)
@@ -480,6 +1048,16 @@ int main(int argc, const char *argv[]) {
 //{ {1,2},{1,4},{1,5},{0,8},{3,8},{4,8} };
 //{ {0,4},{0,6},{1,6},{2,6},{3,6},{4,7},{2,8},{5,8} };
   
+  if (argc > 1 && string(argv[1]) == "--self-check")
+  {
+    return self_check() ? 0 : 1;
+  }
+  if (argc > 1 && string(argv[1]) == "--benchmark")
+  {
+    benchmark(edges_with_cycle, edges_without_cycle);
+    return 0;
+  }
+
   check_for_cycles(edges_with_cycle);
   check_for_cycles(edges_without_cycle);
 